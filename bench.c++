@@ -0,0 +1,296 @@
+// Benchmark for the SocialNetwork operations on synthetic social graphs.
+//
+// Build:  g++ -std=c++11 -O2 -pthread -x c++ -o bench bench.c++
+// Run:    ./bench --model ba --people 1000000 --degree 8 --queries 20000 > results.json
+//
+// Prints a readable summary to stderr and one JSON document to stdout.
+#define SOCIAL_NETWORK_NO_MAIN
+#include "CP.C++"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+typedef chrono::steady_clock Clock;
+
+// Peak resident set size of this process in bytes (0 where unavailable).
+uint64_t peakRssBytes() {
+#if defined(__APPLE__)
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<uint64_t>(usage.ru_maxrss) : 0;
+#elif !defined(_WIN32)
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<uint64_t>(usage.ru_maxrss) * 1024 : 0;
+#else
+    return 0;
+#endif
+}
+
+struct BenchConfig {
+    string model = "ba"; // "ba" (Barabasi-Albert) or "ws" (Watts-Strogatz small world)
+    uint32_t people = 100000;
+    uint32_t degree = 8;  // BA: connections per new person; WS: ring neighbors per person
+    double rewire = 0.1;  // WS only
+    size_t queries = 10000;
+    uint32_t seed = 42;
+};
+
+// Barabasi-Albert preferential attachment: each new person links to `m` existing people
+// picked with probability proportional to their degree, which gives power-law degrees.
+// Sampling from the list of all edge endpoints makes each pick O(1).
+vector<pair<uint32_t, uint32_t>> generateBarabasiAlbert(uint32_t people, uint32_t m, mt19937_64 &rng) {
+    vector<pair<uint32_t, uint32_t>> edges;
+    vector<uint32_t> endpoints;
+    m = max<uint32_t>(1, min(m, people > 1 ? people - 1 : 1));
+    edges.reserve(static_cast<size_t>(people) * m);
+    endpoints.reserve(static_cast<size_t>(people) * m * 2);
+
+    // Start from a small clique so the first picks have something to attach to.
+    uint32_t seedSize = min(people, m + 1);
+    for (uint32_t u = 0; u < seedSize; ++u) {
+        for (uint32_t v = u + 1; v < seedSize; ++v) {
+            edges.emplace_back(u, v);
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    vector<uint32_t> picked;
+    for (uint32_t u = seedSize; u < people; ++u) {
+        picked.clear();
+        uniform_int_distribution<size_t> pick(0, endpoints.size() - 1);
+        while (picked.size() < m) {
+            uint32_t v = endpoints[pick(rng)];
+            if (find(picked.begin(), picked.end(), v) == picked.end()) picked.push_back(v);
+        }
+        for (uint32_t v : picked) {
+            edges.emplace_back(u, v);
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    return edges;
+}
+
+// Watts-Strogatz: a ring where everyone knows their k nearest neighbors, with each link
+// rewired to a random person with probability p. High clustering, short paths.
+vector<pair<uint32_t, uint32_t>> generateWattsStrogatz(uint32_t people, uint32_t k, double p, mt19937_64 &rng) {
+    vector<pair<uint32_t, uint32_t>> edges;
+    uint32_t half = max<uint32_t>(1, k / 2);
+    edges.reserve(static_cast<size_t>(people) * half);
+    uniform_real_distribution<double> coin(0.0, 1.0);
+    uniform_int_distribution<uint32_t> anyone(0, people - 1);
+    for (uint32_t u = 0; u < people; ++u) {
+        for (uint32_t j = 1; j <= half; ++j) {
+            uint32_t v = static_cast<uint32_t>((static_cast<uint64_t>(u) + j) % people);
+            if (coin(rng) < p) v = anyone(rng);
+            if (v != u) edges.emplace_back(u, v);
+        }
+    }
+    return edges;
+}
+
+string personName(uint32_t id) {
+    return "u" + to_string(id);
+}
+
+struct OpResult {
+    string name;
+    size_t count = 0;
+    double seconds = 0;
+    bool bulk = false; // timed as one call, so there are no per-item latencies
+    double p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0; // microseconds
+};
+
+// Times body(i) for i in [0, count) one call at a time and reports latency percentiles.
+template <class F>
+OpResult timeOperation(const string &name, size_t count, F body) {
+    OpResult result;
+    result.name = name;
+    result.count = count;
+    vector<double> latencies(count);
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        Clock::time_point before = Clock::now();
+        body(i);
+        latencies[i] = chrono::duration<double, micro>(Clock::now() - before).count();
+    }
+    result.seconds = chrono::duration<double>(Clock::now() - start).count();
+    if (count == 0) return result;
+
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double q) { return latencies[min(count - 1, static_cast<size_t>(q * count))]; };
+    result.p50 = percentile(0.50);
+    result.p90 = percentile(0.90);
+    result.p99 = percentile(0.99);
+    result.p999 = percentile(0.999);
+    result.max = latencies.back();
+    return result;
+}
+
+// Times one call that handles `count` items as a whole (bulk import, batch queries). Only
+// the total time and throughput are known, so no latency percentiles are reported.
+template <class F>
+OpResult timeBulk(const string &name, size_t count, F body) {
+    OpResult result;
+    result.name = name;
+    result.count = count;
+    result.bulk = true;
+    Clock::time_point start = Clock::now();
+    body();
+    result.seconds = chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+// Parses a whole argument as a number no larger than `limit`; false on anything else.
+bool parseNumber(const char *text, uint64_t limit, uint64_t &value) {
+    char *end;
+    errno = 0;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || *text == '-' || errno == ERANGE || parsed > limit) return false;
+    value = parsed;
+    return true;
+}
+
+bool parseArgs(int argc, char *argv[], BenchConfig &config) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        const char *value = argv[++i];
+        uint64_t number = 0;
+        if (arg == "--model") {
+            config.model = value;
+        } else if (arg == "--rewire") {
+            char *end;
+            config.rewire = strtod(value, &end);
+            if (end == value || *end != '\0' || !(config.rewire >= 0 && config.rewire <= 1)) return false;
+        } else if (!parseNumber(value, arg == "--queries" ? numeric_limits<uint64_t>::max() : NO_ID - 1, number)) {
+            return false;
+        } else if (arg == "--people") {
+            config.people = static_cast<uint32_t>(number);
+        } else if (arg == "--degree") {
+            config.degree = static_cast<uint32_t>(number);
+        } else if (arg == "--queries") {
+            config.queries = static_cast<size_t>(number);
+        } else if (arg == "--seed") {
+            config.seed = static_cast<uint32_t>(number);
+        } else {
+            return false;
+        }
+    }
+    return (config.model == "ba" || config.model == "ws") && config.people >= 2;
+}
+
+int main(int argc, char *argv[]) {
+    BenchConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        cerr << "Usage: " << argv[0]
+             << " [--model ba|ws] [--people N] [--degree D] [--rewire P] [--queries Q] [--seed S]\n";
+        return 1;
+    }
+
+    mt19937_64 rng(config.seed);
+    Clock::time_point start = Clock::now();
+    vector<pair<uint32_t, uint32_t>> edges = config.model == "ba"
+                                                 ? generateBarabasiAlbert(config.people, config.degree, rng)
+                                                 : generateWattsStrogatz(config.people, config.degree, config.rewire, rng);
+    double generateSeconds = chrono::duration<double>(Clock::now() - start).count();
+    cerr << "Generated " << edges.size() << " connections among " << config.people << " people in "
+         << generateSeconds << " s\n";
+
+    SocialNetwork sn;
+    vector<OpResult> results;
+    size_t imported = 0;
+
+    // Import in slices so the name pairs for tens of millions of edges never coexist in memory.
+    const size_t slice = size_t(1) << 22;
+    results.push_back(timeBulk("importConnections", edges.size(), [&] {
+        vector<pair<string, string>> connections;
+        for (size_t begin = 0; begin < edges.size(); begin += slice) {
+            size_t end = min(edges.size(), begin + slice);
+            connections.clear();
+            for (size_t i = begin; i < end; ++i) {
+                connections.emplace_back(personName(edges[i].first), personName(edges[i].second));
+            }
+            imported += sn.importConnections(connections);
+        }
+    }));
+    edges.clear();
+    edges.shrink_to_fit();
+    results.push_back(timeBulk("recomputeAnalytics", config.people, [&] { sn.recomputeAnalytics(); }));
+
+    // The added connections get their own pairs, and only those that were really new are
+    // removed again, so the graph ends as imported. The read queries draw fresh pairs, which
+    // would otherwise all be one hop apart.
+    size_t q = config.queries;
+    uniform_int_distribution<uint32_t> anyone(0, config.people - 1);
+    auto randomPairs = [&] {
+        vector<pair<string, string>> pairs(q);
+        for (auto &p : pairs) p = make_pair(personName(anyone(rng)), personName(anyone(rng)));
+        return pairs;
+    };
+    vector<pair<string, string>> added = randomPairs(), pairs = randomPairs();
+
+    vector<size_t> created;
+    results.push_back(timeOperation("addConnection", q, [&](size_t i) {
+        if (sn.connect(added[i].first, added[i].second) == EdgeChange::Done) created.push_back(i);
+    }));
+    results.push_back(timeOperation("displayMutualFriends", q, [&](size_t i) {
+        sn.mutualFriends(pairs[i].first, pairs[i].second);
+    }));
+    results.push_back(timeOperation("suggestFriends", q, [&](size_t i) { sn.rankedSuggestions(pairs[i].first); }));
+    results.push_back(timeOperation("findShortestPath", q, [&](size_t i) {
+        sn.shortestPath(pairs[i].first, pairs[i].second);
+    }));
+
+    vector<Query> batch;
+    batch.reserve(q);
+    for (const auto &p : pairs) batch.push_back(Query(QueryKind::ShortestPath, p.first, p.second));
+    results.push_back(timeBulk("runBatch(shortestPath)", q, [&] { sn.runBatch(batch); }));
+
+    results.push_back(timeOperation("removeConnection", created.size(), [&](size_t i) {
+        sn.disconnect(added[created[i]].first, added[created[i]].second);
+    }));
+
+    NetworkSummary summary = sn.networkSummary();
+    uint64_t peakRss = peakRssBytes();
+
+    cerr << "\n";
+    for (const OpResult &r : results) {
+        cerr << r.name << ": " << r.count << " ops in " << r.seconds << " s (" << (r.seconds > 0 ? r.count / r.seconds : 0)
+             << " ops/s)";
+        if (!r.bulk) cerr << ", p50 " << r.p50 << " us, p99 " << r.p99 << " us, max " << r.max << " us";
+        cerr << "\n";
+    }
+    cerr << "Peak RSS: " << peakRss / (1024 * 1024) << " MiB\n";
+
+    ostringstream json;
+    json << "{\n";
+    json << "  \"config\": {\"model\": \"" << config.model << "\", \"people\": " << config.people
+         << ", \"degree\": " << config.degree << ", \"rewire\": " << config.rewire << ", \"queries\": " << config.queries
+         << ", \"seed\": " << config.seed << ", \"threads\": " << max(1u, thread::hardware_concurrency()) << "},\n";
+    json << "  \"graph\": {\"connections\": " << summary.connections << ", \"imported\": " << imported
+         << ", \"components\": " << summary.components << ", \"largestComponent\": " << summary.largestComponent
+         << ", \"triangles\": " << summary.triangles << ", \"maxDegree\": " << summary.degreeHistogram.size() - 1
+         << ", \"generateSeconds\": " << generateSeconds << "},\n";
+    json << "  \"peakRssBytes\": " << peakRss << ",\n";
+    json << "  \"operations\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const OpResult &r = results[i];
+        json << "    {\"name\": \"" << r.name << "\", \"count\": " << r.count << ", \"seconds\": " << r.seconds
+             << ", \"opsPerSecond\": " << (r.seconds > 0 ? r.count / r.seconds : 0);
+        if (!r.bulk) {
+            json << ", \"latencyUs\": {\"p50\": " << r.p50 << ", \"p90\": " << r.p90 << ", \"p99\": " << r.p99
+                 << ", \"p999\": " << r.p999 << ", \"max\": " << r.max << "}";
+        }
+        json << "}" << (i + 1 == results.size() ? "\n" : ",\n");
+    }
+    json << "  ]\n}\n";
+    cout << json.str();
+    return 0;
+}